@@ -2,27 +2,54 @@ using System;
 using System.IO.Pipes;
 using System.Threading;
 using System.Threading.Tasks;
-using System.Collections.Generic;
 using System.Collections.Concurrent;
 using System.Net.Sockets;
 using System.IO;
 
 public static class TrackerReader
 {
+    public enum DeviceClass : byte
+    {
+        Invalid = 0,
+        HMD = 1,
+        Controller = 2,
+        GenericTracker = 3,
+        TrackingReference = 4,
+        DisplayRedirect = 5
+    }
+
     public struct Pose
     {
         public float X, Y, Z;           // Position in meters
         public float Qw, Qx, Qy, Qz;    // Rotation quaternion
+        public float Vx, Vy, Vz;        // Linear velocity in m/s (if HasVelocity)
+        public float Avx, Avy, Avz;     // Angular velocity in rad/s (if HasVelocity)
         public bool Valid;
+        public bool Connected;
+        public bool HasVelocity;
+        public byte DeviceIndex;        // OpenVR device index
+        public DeviceClass Class;
+        public byte Role;               // OpenVR ETrackedControllerRole
+        public ushort TrackingResult;   // OpenVR ETrackingResult
         public string Serial;
     }
 
+    private const int MaxDevices = 64;
+    private const byte EncodingFloat = 0;
+    private const byte EncodingQuantized = 1;
+    private const byte FlagVelocity = 1 << 0;
+    private const byte FlagSerials = 1 << 1;
+    private const float PositionScale = 2048.0f;
+    private const float VelocityScale = 1024.0f;
+    private const float AngularVelocityScale = 512.0f;
+
     private static Stream ipcStream;
     private static ConcurrentQueue<Pose[]> poseQueue = new ConcurrentQueue<Pose[]>();
     private static CancellationTokenSource cancellationSource;
     private static Task readerTask;
     private static bool isInitialized;
-    private static readonly byte[] buffer = new byte[8192]; // Match server buffer size
+    private static readonly string[] serials = new string[MaxDevices]; // Only sent when they change
+    private static readonly byte[] buffer = new byte[MaxDevices * 256]; // Fits the largest section: serial lengths plus serials
 
     /// <summary>
     /// Initializes the tracker reader and starts the background reading task.
@@ -34,23 +61,7 @@ public static class TrackerReader
 
         try
         {
-            if (Environment.OSVersion.Platform == PlatformID.Unix)
-            {
-                // Unix domain socket
-                var socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
-                var endPoint = new UnixDomainSocketEndPoint("/tmp/openxr_tracker_extenuation");
-                await socket.ConnectAsync(endPoint);
-                ipcStream = new NetworkStream(socket);
-                Console.WriteLine("Connecting to Unix domain socket: /tmp/openxr_tracker_extenuation");
-            }
-            else
-            {
-                // Windows named pipe
-                var pipeClient = new NamedPipeClientStream(".", "openxr_tracker_extenuation", PipeDirection.In);
-                Console.WriteLine("Connecting to Windows named pipe: openxr_tracker_extenuation");
-                await pipeClient.ConnectAsync();
-                ipcStream = pipeClient;
-            }
+            await ConnectAsync(CancellationToken.None);
 
             cancellationSource = new CancellationTokenSource();
             readerTask = RunReaderLoop(cancellationSource.Token);
@@ -64,14 +75,51 @@ public static class TrackerReader
         }
     }
 
+    private static async Task ConnectAsync(CancellationToken token)
+    {
+        if (Environment.OSVersion.Platform == PlatformID.Unix)
+        {
+            // Unix domain socket
+            var socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
+            var endPoint = new UnixDomainSocketEndPoint("/tmp/openxr_tracker_extenuation");
+            try
+            {
+                await socket.ConnectAsync(endPoint);
+            }
+            catch
+            {
+                socket.Dispose();
+                throw;
+            }
+            ipcStream = new NetworkStream(socket, ownsSocket: true);
+            Console.WriteLine("Connected to Unix domain socket: /tmp/openxr_tracker_extenuation");
+        }
+        else
+        {
+            // Windows named pipe
+            var pipeClient = new NamedPipeClientStream(".", "openxr_tracker_extenuation", PipeDirection.In);
+            Console.WriteLine("Connecting to Windows named pipe: openxr_tracker_extenuation");
+            try
+            {
+                await pipeClient.ConnectAsync(token);
+            }
+            catch
+            {
+                pipeClient.Dispose();
+                throw;
+            }
+            ipcStream = pipeClient;
+        }
+    }
+
     private static async Task RunReaderLoop(CancellationToken token)
     {
         while (!token.IsCancellationRequested)
         {
             try
             {
-                var poses = await ReadTrackersAsync();
-                poseQueue.Enqueue(poses.ToArray());
+                var poses = await ReadFrameAsync(ipcStream);
+                poseQueue.Enqueue(poses);
 
                 // Only keep the latest frame
                 while (poseQueue.Count > 1)
@@ -79,68 +127,210 @@ public static class TrackerReader
                     poseQueue.TryDequeue(out _);
                 }
             }
+            catch (OperationCanceledException)
+            {
+                break;
+            }
             catch (Exception e)
             {
-                Console.WriteLine($"Error in reader loop: {e.Message}");
-                await Task.Delay(1000, token); // Wait before retrying
+                // The stream has no framing, so after a bad header, a closed
+                // stream or any error mid-frame the position in the stream is
+                // lost. Drop the connection rather than parse garbage.
+                Console.WriteLine($"IPC stream lost ({e.Message}), reconnecting...");
+                try
+                {
+                    await ReconnectAsync(token);
+                }
+                catch (OperationCanceledException)
+                {
+                    break;
+                }
             }
         }
     }
 
-    private static async Task<List<Pose>> ReadTrackersAsync()
+    private static async Task ReconnectAsync(CancellationToken token)
     {
-        var poses = new List<Pose>();
+        ipcStream?.Dispose();
+        ipcStream = null;
 
-        try
+        // The server resends serial numbers to every new connection
+        Array.Clear(serials, 0, serials.Length);
+        while (poseQueue.TryDequeue(out _)) { }
+
+        while (true)
         {
-            // Read number of trackers
-            await ReadExactAsync(buffer, 0, sizeof(uint));
-            uint numTrackers = BitConverter.ToUInt32(buffer, 0);
+            await Task.Delay(1000, token); // Wait before retrying
+            try
+            {
+                await ConnectAsync(token);
+                return;
+            }
+            catch (Exception) when (!token.IsCancellationRequested)
+            {
+                // Server not accepting yet, keep trying quietly
+            }
+        }
+    }
 
-            for (int i = 0; i < numTrackers; i++)
+    /// <summary>
+    /// Reads one frame from the stream. Serial numbers are cached between
+    /// frames because the server only sends them when they change.
+    /// Throws InvalidDataException for malformed headers and
+    /// EndOfStreamException if the stream ends mid-frame.
+    /// </summary>
+    internal static async Task<Pose[]> ReadFrameAsync(Stream stream)
+    {
+        // Header: device count, encoding, flags
+        await ReadExactAsync(stream, buffer, 0, sizeof(uint) + 2);
+        uint numDevices = BitConverter.ToUInt32(buffer, 0);
+        byte encoding = buffer[4];
+        byte flags = buffer[5];
+
+        if (numDevices > MaxDevices)
+        {
+            throw new InvalidDataException($"Invalid device count {numDevices}");
+        }
+        if (encoding != EncodingFloat && encoding != EncodingQuantized)
+        {
+            throw new InvalidDataException($"Unknown encoding {encoding}");
+        }
+        if ((flags & ~(FlagVelocity | FlagSerials)) != 0)
+        {
+            throw new InvalidDataException($"Unknown flags {flags}");
+        }
+
+        int n = (int)numDevices;
+        bool quantized = encoding == EncodingQuantized;
+        bool hasVelocity = (flags & FlagVelocity) != 0;
+        bool hasSerials = (flags & FlagSerials) != 0;
+        var poses = new Pose[n];
+
+        // Device metadata: index, class, role, status (1 byte each), tracking result (2 bytes)
+        await ReadExactAsync(stream, buffer, 0, n * 6);
+        for (int i = 0; i < n; i++)
+        {
+            poses[i].DeviceIndex = buffer[i];
+            poses[i].Class = (DeviceClass)buffer[n + i];
+            poses[i].Role = buffer[2 * n + i];
+            poses[i].Valid = (buffer[3 * n + i] & 1) != 0;
+            poses[i].Connected = (buffer[3 * n + i] & 2) != 0;
+            poses[i].TrackingResult = BitConverter.ToUInt16(buffer, 4 * n + i * 2);
+            poses[i].HasVelocity = hasVelocity;
+        }
+
+        // Pose
+        if (quantized)
+        {
+            await ReadExactAsync(stream, buffer, 0, n * (3 * sizeof(short) + sizeof(uint)));
+            for (int i = 0; i < n; i++)
             {
-                var pose = new Pose();
-
-                // Read position (3 floats)
-                await ReadExactAsync(buffer, 0, sizeof(float) * 3);
-                pose.X = BitConverter.ToSingle(buffer, 0);
-                pose.Y = BitConverter.ToSingle(buffer, 4);
-                pose.Z = BitConverter.ToSingle(buffer, 8);
-
-                // Read rotation (4 floats)
-                await ReadExactAsync(buffer, 0, sizeof(float) * 4);
-                pose.Qw = BitConverter.ToSingle(buffer, 0);
-                pose.Qx = BitConverter.ToSingle(buffer, 4);
-                pose.Qy = BitConverter.ToSingle(buffer, 8);
-                pose.Qz = BitConverter.ToSingle(buffer, 12);
-
-                // Read validity
-                await ReadExactAsync(buffer, 0, sizeof(byte));
-                pose.Valid = buffer[0] != 0;
-
-                // Read serial number
-                await ReadExactAsync(buffer, 0, sizeof(uint));
-                uint serialLength = BitConverter.ToUInt32(buffer, 0);
-                await ReadExactAsync(buffer, 0, (int)serialLength);
-                pose.Serial = System.Text.Encoding.ASCII.GetString(buffer, 0, (int)serialLength);
-
-                poses.Add(pose);
+                poses[i].X = BitConverter.ToInt16(buffer, i * 2) / PositionScale;
+                poses[i].Y = BitConverter.ToInt16(buffer, (n + i) * 2) / PositionScale;
+                poses[i].Z = BitConverter.ToInt16(buffer, (2 * n + i) * 2) / PositionScale;
+                UnpackQuaternion(BitConverter.ToUInt32(buffer, 6 * n + i * 4), ref poses[i]);
             }
         }
-        catch (Exception)
+        else
         {
-            throw;
+            await ReadExactAsync(stream, buffer, 0, n * 7 * sizeof(float));
+            for (int i = 0; i < n; i++)
+            {
+                poses[i].X = BitConverter.ToSingle(buffer, i * 4);
+                poses[i].Y = BitConverter.ToSingle(buffer, (n + i) * 4);
+                poses[i].Z = BitConverter.ToSingle(buffer, (2 * n + i) * 4);
+                poses[i].Qw = BitConverter.ToSingle(buffer, (3 * n + i) * 4);
+                poses[i].Qx = BitConverter.ToSingle(buffer, (4 * n + i) * 4);
+                poses[i].Qy = BitConverter.ToSingle(buffer, (5 * n + i) * 4);
+                poses[i].Qz = BitConverter.ToSingle(buffer, (6 * n + i) * 4);
+            }
+        }
+
+        // Velocities
+        if (hasVelocity)
+        {
+            int size = quantized ? sizeof(short) : sizeof(float);
+            await ReadExactAsync(stream, buffer, 0, n * 6 * size);
+            for (int i = 0; i < n; i++)
+            {
+                poses[i].Vx = ReadValue(buffer, i, size, VelocityScale);
+                poses[i].Vy = ReadValue(buffer, n + i, size, VelocityScale);
+                poses[i].Vz = ReadValue(buffer, 2 * n + i, size, VelocityScale);
+                poses[i].Avx = ReadValue(buffer, 3 * n + i, size, AngularVelocityScale);
+                poses[i].Avy = ReadValue(buffer, 4 * n + i, size, AngularVelocityScale);
+                poses[i].Avz = ReadValue(buffer, 5 * n + i, size, AngularVelocityScale);
+            }
+        }
+
+        // Serial numbers, only present when the device list changed:
+        // lengths, then concatenated strings read in one call
+        if (hasSerials)
+        {
+            await ReadExactAsync(stream, buffer, 0, n);
+            int totalSerialLength = 0;
+            for (int i = 0; i < n; i++)
+            {
+                totalSerialLength += buffer[i];
+            }
+            await ReadExactAsync(stream, buffer, n, totalSerialLength);
+            int serialOffset = n;
+            for (int i = 0; i < n; i++)
+            {
+                serials[i] = System.Text.Encoding.ASCII.GetString(buffer, serialOffset, buffer[i]);
+                serialOffset += buffer[i];
+            }
+        }
+        for (int i = 0; i < n; i++)
+        {
+            poses[i].Serial = serials[i];
         }
 
         return poses;
     }
 
-    private static async Task ReadExactAsync(byte[] buffer, int offset, int count)
+    private static float ReadValue(byte[] data, int index, int size, float scale)
+    {
+        return size == sizeof(short)
+            ? BitConverter.ToInt16(data, index * size) / scale
+            : BitConverter.ToSingle(data, index * size);
+    }
+
+    // Rebuild a quaternion packed as the largest component's index (2 bits)
+    // followed by the remaining three components (10 bits each)
+    private static void UnpackQuaternion(uint packed, ref Pose pose)
+    {
+        Span<float> q = stackalloc float[4];
+        int largest = (int)(packed >> 30);
+        int shift = 20;
+        float sumSq = 0.0f;
+        for (int i = 0; i < 4; i++)
+        {
+            if (i == largest) continue;
+            uint component = (packed >> shift) & 1023;
+            q[i] = (component / 1023.0f * 2.0f - 1.0f) / MathF.Sqrt(2.0f);
+            sumSq += q[i] * q[i];
+            shift -= 10;
+        }
+        q[largest] = MathF.Sqrt(Math.Max(0.0f, 1.0f - sumSq));
+        float invNorm = 1.0f / MathF.Sqrt(sumSq + q[largest] * q[largest]);
+
+        pose.Qw = q[0] * invNorm;
+        pose.Qx = q[1] * invNorm;
+        pose.Qy = q[2] * invNorm;
+        pose.Qz = q[3] * invNorm;
+    }
+
+    private static async Task ReadExactAsync(Stream stream, byte[] buffer, int offset, int count)
     {
         int bytesRead = 0;
         while (bytesRead < count)
         {
-            bytesRead += await ipcStream.ReadAsync(buffer, offset + bytesRead, count - bytesRead);
+            int read = await stream.ReadAsync(buffer, offset + bytesRead, count - bytesRead);
+            if (read == 0)
+            {
+                throw new EndOfStreamException("IPC stream closed");
+            }
+            bytesRead += read;
         }
     }
 
@@ -0,0 +1,174 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading.Tasks;
+
+// Decodes the shared wire fixtures with TrackerReader and checks the values
+// described at the top of tests/fixtures/wire_frames.txt.
+// Usage: dotnet run --project csharp_client/fixture_check -- tests/fixtures/wire_frames.txt
+public static class FixtureCheck
+{
+    private static int failures = 0;
+
+    private static void Check(bool condition, string message)
+    {
+        if (!condition)
+        {
+            Console.Error.WriteLine(message);
+            failures++;
+        }
+    }
+
+    // Read the [name] sections of hex bytes, in file order
+    private static List<KeyValuePair<string, byte[]>> LoadFixtures(string path)
+    {
+        var fixtures = new List<KeyValuePair<string, byte[]>>();
+        string name = null;
+        var bytes = new List<byte>();
+        foreach (var rawLine in File.ReadAllLines(path))
+        {
+            int comment = rawLine.IndexOf('#');
+            string line = (comment >= 0 ? rawLine.Substring(0, comment) : rawLine).Trim();
+            if (line.StartsWith("["))
+            {
+                if (name != null) fixtures.Add(new KeyValuePair<string, byte[]>(name, bytes.ToArray()));
+                name = line.Trim('[', ']');
+                bytes.Clear();
+                continue;
+            }
+            foreach (var token in line.Split(new[] { ' ', '\t' }, StringSplitOptions.RemoveEmptyEntries))
+            {
+                bytes.Add(Convert.ToByte(token, 16));
+            }
+        }
+        if (name != null) fixtures.Add(new KeyValuePair<string, byte[]>(name, bytes.ToArray()));
+        return fixtures;
+    }
+
+    // The two devices described at the top of the fixture file
+    private static TrackerReader.Pose[] ExpectedPoses()
+    {
+        return new[]
+        {
+            new TrackerReader.Pose
+            {
+                DeviceIndex = 0, Class = TrackerReader.DeviceClass.HMD, Role = 0, Valid = true, Connected = true,
+                TrackingResult = 200, X = 1.0f, Y = 1.5f, Z = -0.25f, Qw = 1.0f, Qx = 0.0f, Qy = 0.0f, Qz = 0.0f,
+                Vx = 0.5f, Vy = 0.0f, Vz = -1.0f, Avx = 0.0f, Avy = 2.0f, Avz = 0.0f, Serial = "HMD1"
+            },
+            new TrackerReader.Pose
+            {
+                DeviceIndex = 3, Class = TrackerReader.DeviceClass.Controller, Role = 2, Valid = true, Connected = false,
+                TrackingResult = 201, X = -2.0f, Y = 0.75f, Z = 0.5f, Qw = 0.0f, Qx = 0.0f, Qy = 1.0f, Qz = 0.0f,
+                Vx = 0.0f, Vy = 0.0f, Vz = 0.0f, Avx = -1.0f, Avy = 0.0f, Avz = 0.5f, Serial = "LHR-1"
+            }
+        };
+    }
+
+    private static async Task CheckFixture(string name, byte[] bytes)
+    {
+        bool quantized = name.StartsWith("quantized");
+        bool hasVelocity = name.Contains("velocity");
+        float tolerance = quantized ? 2e-3f : 0.0f;
+        bool Near(float a, float b) => Math.Abs(a - b) <= tolerance;
+
+        var stream = new MemoryStream(bytes);
+        TrackerReader.Pose[] poses;
+        try
+        {
+            poses = await TrackerReader.ReadFrameAsync(stream);
+        }
+        catch (Exception e)
+        {
+            Check(false, $"{name}: failed to decode: {e.Message}");
+            return;
+        }
+
+        Check(stream.Position == bytes.Length, $"{name}: read {stream.Position} of {bytes.Length} bytes");
+        Check(poses.Length == 2, $"{name}: {poses.Length} devices");
+        if (poses.Length != 2) return;
+
+        var expected = ExpectedPoses();
+        for (int i = 0; i < 2; i++)
+        {
+            var p = poses[i];
+            var e = expected[i];
+            Check(p.DeviceIndex == e.DeviceIndex && p.Class == e.Class && p.Role == e.Role && p.Valid == e.Valid &&
+                  p.Connected == e.Connected && p.TrackingResult == e.TrackingResult,
+                  $"{name}: metadata {i} mismatch");
+            Check(p.X == e.X && p.Y == e.Y && p.Z == e.Z, $"{name}: position {i} mismatch");
+            Check(Near(p.Qw, e.Qw) && Near(p.Qx, e.Qx) && Near(p.Qy, e.Qy) && Near(p.Qz, e.Qz),
+                  $"{name}: rotation {i} mismatch");
+            Check(p.HasVelocity == hasVelocity, $"{name}: velocity flag {i} mismatch");
+            if (hasVelocity)
+            {
+                Check(p.Vx == e.Vx && p.Vy == e.Vy && p.Vz == e.Vz && p.Avx == e.Avx && p.Avy == e.Avy &&
+                      p.Avz == e.Avz, $"{name}: velocity {i} mismatch");
+            }
+            // Frames without serials keep the ones from the previous fixture
+            Check(p.Serial == e.Serial, $"{name}: serial {i} is \"{p.Serial}\"");
+        }
+    }
+
+    private static async Task CheckRejected<T>(string name, byte[] bytes) where T : Exception
+    {
+        try
+        {
+            await TrackerReader.ReadFrameAsync(new MemoryStream(bytes));
+            Check(false, $"{name}: accepted");
+        }
+        catch (T)
+        {
+        }
+        catch (Exception e)
+        {
+            Check(false, $"{name}: threw {e.GetType().Name} instead of {typeof(T).Name}");
+        }
+    }
+
+    public static async Task<int> Main(string[] args)
+    {
+        if (args.Length != 1)
+        {
+            Console.Error.WriteLine("Usage: FixtureCheck <wire_frames.txt>");
+            return 1;
+        }
+
+        var fixtures = LoadFixtures(args[0]);
+        Check(fixtures.Count == 5, $"expected 5 fixtures, found {fixtures.Count}");
+        foreach (var fixture in fixtures)
+        {
+            await CheckFixture(fixture.Key, fixture.Value);
+        }
+
+        // Malformed headers must be rejected the same way as by FrameDecoder
+        byte[] Header(uint count, byte encoding, byte flags)
+        {
+            var bytes = new byte[6 + 4096];
+            BitConverter.GetBytes(count).CopyTo(bytes, 0);
+            bytes[4] = encoding;
+            bytes[5] = flags;
+            return bytes;
+        }
+        await CheckRejected<InvalidDataException>("device count above maximum", Header(65, 0, 0));
+        await CheckRejected<InvalidDataException>("huge device count", Header(0xFFFFFFFFu, 0, 0));
+        await CheckRejected<InvalidDataException>("unknown encoding", Header(1, 2, 0));
+        await CheckRejected<InvalidDataException>("unknown flags", Header(1, 0, 0x84));
+
+        // A truncated frame must fail rather than return partial poses
+        foreach (var fixture in fixtures)
+        {
+            var truncated = new byte[fixture.Value.Length - 1];
+            Array.Copy(fixture.Value, truncated, truncated.Length);
+            await CheckRejected<EndOfStreamException>($"{fixture.Key} truncated", truncated);
+        }
+
+        if (failures > 0)
+        {
+            Console.Error.WriteLine($"{failures} check(s) failed");
+            return 1;
+        }
+        Console.WriteLine("All C# fixture checks passed");
+        return 0;
+    }
+}
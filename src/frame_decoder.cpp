@@ -0,0 +1,157 @@
+#include "frame_decoder.hpp"
+#include <cstring>
+
+namespace {
+    // Bounds-checked sequential reader over the input buffer
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : m_data(data), m_size(size), m_offset(0) {}
+
+        bool has(size_t bytes) const { return bytes <= m_size - m_offset; }
+        size_t offset() const { return m_offset; }
+
+        template <typename T>
+        void read(T* out, size_t count) {
+            if (count > 0) {
+                memcpy(out, m_data + m_offset, sizeof(T) * count);
+            }
+            m_offset += sizeof(T) * count;
+        }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_offset;
+    };
+}
+
+FrameDecoder::Result FrameDecoder::decode(const uint8_t* data, size_t size, TrackerFrame& frame, Info& info) {
+    Reader reader(data, size);
+
+    // Header
+    if (!reader.has(kHeaderSize)) {
+        return Result::Incomplete;
+    }
+    uint32_t count;
+    uint8_t encodingValue;
+    uint8_t flags;
+    reader.read(&count, 1);
+    reader.read(&encodingValue, 1);
+    reader.read(&flags, 1);
+
+    if (count > TrackerFrame::kMaxDevices) {
+        return Result::Invalid;
+    }
+    if (encodingValue != static_cast<uint8_t>(FrameEncoder::Encoding::Float) &&
+        encodingValue != static_cast<uint8_t>(FrameEncoder::Encoding::Quantized)) {
+        return Result::Invalid;
+    }
+    if ((flags & ~(FrameEncoder::kFlagVelocity | FrameEncoder::kFlagSerials)) != 0) {
+        return Result::Invalid;
+    }
+
+    const size_t n = count;
+    const bool quantized = encodingValue == static_cast<uint8_t>(FrameEncoder::Encoding::Quantized);
+    const bool hasVelocity = (flags & FrameEncoder::kFlagVelocity) != 0;
+    const bool hasSerials = (flags & FrameEncoder::kFlagSerials) != 0;
+
+    // Everything up to and including the serial lengths has a fixed size
+    size_t perDevice = 4 * sizeof(uint8_t) + sizeof(uint16_t);
+    if (hasSerials) perDevice += sizeof(uint8_t);
+    if (quantized) {
+        perDevice += 3 * sizeof(int16_t) + sizeof(uint32_t);
+        if (hasVelocity) perDevice += 6 * sizeof(int16_t);
+    } else {
+        perDevice += 7 * sizeof(float);
+        if (hasVelocity) perDevice += 6 * sizeof(float);
+    }
+    if (!reader.has(n * perDevice)) {
+        return Result::Incomplete;
+    }
+
+    // The serial lengths end the fixed size part; make sure the serials that
+    // follow are present too before anything is written to frame
+    uint8_t serialLength[TrackerFrame::kMaxDevices];
+    size_t totalSerialLength = 0;
+    if (hasSerials) {
+        memcpy(serialLength, data + kHeaderSize + n * (perDevice - 1), n);
+        for (size_t i = 0; i < n; ++i) {
+            totalSerialLength += serialLength[i];
+        }
+        if (!reader.has(n * perDevice + totalSerialLength)) {
+            return Result::Incomplete;
+        }
+    }
+
+    frame.count = count;
+    frame.hasVelocity = hasVelocity;
+
+    // Device metadata
+    reader.read(frame.deviceIndex.data(), n);
+    reader.read(frame.deviceClass.data(), n);
+    reader.read(frame.role.data(), n);
+    reader.read(frame.status.data(), n);
+    reader.read(frame.trackingResult.data(), n);
+
+    int16_t fixed[TrackerFrame::kMaxDevices];
+    auto readFixed = [&](std::array<float, TrackerFrame::kMaxDevices>& values, float scale) {
+        reader.read(fixed, n);
+        for (size_t i = 0; i < n; ++i) {
+            values[i] = FrameEncoder::dequantize(fixed[i], scale);
+        }
+    };
+
+    // Pose
+    if (quantized) {
+        readFixed(frame.x, FrameEncoder::kPositionScale);
+        readFixed(frame.y, FrameEncoder::kPositionScale);
+        readFixed(frame.z, FrameEncoder::kPositionScale);
+
+        uint32_t rotation[TrackerFrame::kMaxDevices];
+        reader.read(rotation, n);
+        for (size_t i = 0; i < n; ++i) {
+            FrameEncoder::unpackQuaternion(rotation[i], frame.qw[i], frame.qx[i], frame.qy[i], frame.qz[i]);
+        }
+    } else {
+        reader.read(frame.x.data(), n);
+        reader.read(frame.y.data(), n);
+        reader.read(frame.z.data(), n);
+        reader.read(frame.qw.data(), n);
+        reader.read(frame.qx.data(), n);
+        reader.read(frame.qy.data(), n);
+        reader.read(frame.qz.data(), n);
+    }
+
+    // Velocities
+    if (hasVelocity) {
+        if (quantized) {
+            readFixed(frame.vx, FrameEncoder::kVelocityScale);
+            readFixed(frame.vy, FrameEncoder::kVelocityScale);
+            readFixed(frame.vz, FrameEncoder::kVelocityScale);
+            readFixed(frame.avx, FrameEncoder::kAngularVelocityScale);
+            readFixed(frame.avy, FrameEncoder::kAngularVelocityScale);
+            readFixed(frame.avz, FrameEncoder::kAngularVelocityScale);
+        } else {
+            reader.read(frame.vx.data(), n);
+            reader.read(frame.vy.data(), n);
+            reader.read(frame.vz.data(), n);
+            reader.read(frame.avx.data(), n);
+            reader.read(frame.avy.data(), n);
+            reader.read(frame.avz.data(), n);
+        }
+    }
+
+    // Serial numbers
+    if (hasSerials) {
+        reader.read(serialLength, n);
+        for (size_t i = 0; i < n; ++i) {
+            frame.serial[i].resize(serialLength[i]);
+            reader.read(&frame.serial[i][0], serialLength[i]);
+        }
+    }
+
+    info.size = reader.offset();
+    info.encoding = static_cast<FrameEncoder::Encoding>(encodingValue);
+    info.hasSerials = hasSerials;
+    return Result::Ok;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "tracker_frame.hpp"
+#include "frame_encoder.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Reference decoder for the byte layout produced by FrameEncoder.
+// Every length is validated before it is used, so arbitrary input is safe.
+class FrameDecoder {
+public:
+    enum class Result {
+        Ok,          // A full frame was decoded
+        Incomplete,  // More bytes are needed to decode the frame
+        Invalid      // The bytes cannot be the start of a frame
+    };
+
+    // Details of a decoded frame
+    struct Info {
+        size_t size;                     // Encoded size of the frame in bytes
+        FrameEncoder::Encoding encoding; // Encoding the frame used
+        bool hasSerials;                 // Whether the frame carried serial numbers
+    };
+
+    // Decode one frame from the start of data. frame is only written when the
+    // result is Ok, so it keeps the last good frame while bytes are pending.
+    // Frames without serial numbers leave frame.serial as it was.
+    static Result decode(const uint8_t* data, size_t size, TrackerFrame& frame, Info& info);
+
+    // Size of the header (count, encoding, flags)
+    static constexpr size_t kHeaderSize = sizeof(uint32_t) + 2;
+};
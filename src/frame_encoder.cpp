@@ -0,0 +1,203 @@
+#include "frame_encoder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    const float kSqrt2 = 1.41421356f;
+    const uint32_t kComponentMax = (1u << 10) - 1;
+}
+
+FrameEncoder::FrameEncoder(Encoding encoding) : m_encoding(encoding), m_serialsSent(false) {
+}
+
+template <typename T>
+void FrameEncoder::append(const T* data, size_t count) {
+    size_t offset = m_buffer.size();
+    m_buffer.resize(offset + sizeof(T) * count);
+    if (count > 0) {
+        memcpy(m_buffer.data() + offset, data, sizeof(T) * count);
+    }
+}
+
+int16_t FrameEncoder::quantize(float value, float scale) {
+    if (!std::isfinite(value)) {
+        return 0;
+    }
+    float scaled = std::round(value * scale);
+    scaled = std::min(std::max(scaled, -32767.0f), 32767.0f);
+    return static_cast<int16_t>(scaled);
+}
+
+float FrameEncoder::dequantize(int16_t value, float scale) {
+    return static_cast<float>(value) / scale;
+}
+
+uint32_t FrameEncoder::packQuaternion(float qw, float qx, float qy, float qz) {
+    float q[4] = {qw, qx, qy, qz};
+
+    // Normalize so the three stored components fit their range; anything
+    // that cannot be normalized is sent as the identity rotation
+    float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (!std::isfinite(norm) || norm < 0.0001f) {
+        q[0] = 1.0f;
+        q[1] = q[2] = q[3] = 0.0f;
+    } else {
+        for (float& c : q) c /= norm;
+    }
+
+    // Find the largest component; it is dropped and rebuilt from the others
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::fabs(q[i]) > std::fabs(q[largest])) largest = i;
+    }
+
+    // q and -q are the same rotation, so make the dropped component positive
+    float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+    // Remaining components lie in [-1/sqrt(2), 1/sqrt(2)]
+    uint32_t packed = largest << 30;
+    int shift = 20;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float normalized = (q[i] * sign * kSqrt2 + 1.0f) * 0.5f;
+        normalized = std::min(std::max(normalized, 0.0f), 1.0f);
+        uint32_t component = static_cast<uint32_t>(std::lround(normalized * kComponentMax));
+        packed |= component << shift;
+        shift -= 10;
+    }
+
+    return packed;
+}
+
+void FrameEncoder::unpackQuaternion(uint32_t packed, float& qw, float& qx, float& qy, float& qz) {
+    float q[4];
+    uint32_t largest = packed >> 30;
+    int shift = 20;
+    float sumSq = 0.0f;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        uint32_t component = (packed >> shift) & kComponentMax;
+        q[i] = (static_cast<float>(component) / kComponentMax * 2.0f - 1.0f) / kSqrt2;
+        sumSq += q[i] * q[i];
+        shift -= 10;
+    }
+    q[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+
+    // Arbitrary input can hold components whose squares sum past one
+    float inv_norm = 1.0f / std::sqrt(sumSq + q[largest] * q[largest]);
+
+    qw = q[0] * inv_norm;
+    qx = q[1] * inv_norm;
+    qy = q[2] * inv_norm;
+    qz = q[3] * inv_norm;
+}
+
+bool FrameEncoder::serialsChanged(const TrackerFrame& frame) const {
+    const size_t n = std::min<size_t>(frame.count, TrackerFrame::kMaxDevices);
+    if (!m_serialsSent || m_sentSerials.size() != n) {
+        return true;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (m_sentSerials[i] != frame.serial[i]) return true;
+    }
+    return false;
+}
+
+const std::vector<uint8_t>& FrameEncoder::encode(const TrackerFrame& frame) {
+    if (!serialsChanged(frame)) {
+        return encode(frame, false);
+    }
+
+    const size_t n = std::min<size_t>(frame.count, TrackerFrame::kMaxDevices);
+    m_sentSerials.assign(frame.serial.begin(), frame.serial.begin() + n);
+    m_serialsSent = true;
+    return encode(frame, true);
+}
+
+const std::vector<uint8_t>& FrameEncoder::encode(const TrackerFrame& frame, bool includeSerials) {
+    const size_t n = std::min<size_t>(frame.count, TrackerFrame::kMaxDevices);
+    const bool quantized = m_encoding == Encoding::Quantized;
+
+    m_buffer.clear();
+
+    // Header
+    uint32_t count = static_cast<uint32_t>(n);
+    uint8_t encoding = static_cast<uint8_t>(m_encoding);
+    uint8_t flags = 0;
+    if (frame.hasVelocity) flags |= kFlagVelocity;
+    if (includeSerials) flags |= kFlagSerials;
+    append(&count, 1);
+    append(&encoding, 1);
+    append(&flags, 1);
+
+    // Device metadata
+    append(frame.deviceIndex.data(), n);
+    append(frame.deviceClass.data(), n);
+    append(frame.role.data(), n);
+    append(frame.status.data(), n);
+    append(frame.trackingResult.data(), n);
+
+    int16_t fixed[TrackerFrame::kMaxDevices];
+    auto appendFixed = [&](const std::array<float, TrackerFrame::kMaxDevices>& values, float scale) {
+        for (size_t i = 0; i < n; ++i) {
+            fixed[i] = quantize(values[i], scale);
+        }
+        append(fixed, n);
+    };
+
+    // Pose
+    if (quantized) {
+        appendFixed(frame.x, kPositionScale);
+        appendFixed(frame.y, kPositionScale);
+        appendFixed(frame.z, kPositionScale);
+
+        uint32_t rotation[TrackerFrame::kMaxDevices];
+        for (size_t i = 0; i < n; ++i) {
+            rotation[i] = packQuaternion(frame.qw[i], frame.qx[i], frame.qy[i], frame.qz[i]);
+        }
+        append(rotation, n);
+    } else {
+        append(frame.x.data(), n);
+        append(frame.y.data(), n);
+        append(frame.z.data(), n);
+        append(frame.qw.data(), n);
+        append(frame.qx.data(), n);
+        append(frame.qy.data(), n);
+        append(frame.qz.data(), n);
+    }
+
+    // Velocities
+    if (frame.hasVelocity) {
+        if (quantized) {
+            appendFixed(frame.vx, kVelocityScale);
+            appendFixed(frame.vy, kVelocityScale);
+            appendFixed(frame.vz, kVelocityScale);
+            appendFixed(frame.avx, kAngularVelocityScale);
+            appendFixed(frame.avy, kAngularVelocityScale);
+            appendFixed(frame.avz, kAngularVelocityScale);
+        } else {
+            append(frame.vx.data(), n);
+            append(frame.vy.data(), n);
+            append(frame.vz.data(), n);
+            append(frame.avx.data(), n);
+            append(frame.avy.data(), n);
+            append(frame.avz.data(), n);
+        }
+    }
+
+    // Serial numbers
+    if (!includeSerials) {
+        return m_buffer;
+    }
+    uint8_t serialLength[TrackerFrame::kMaxDevices];
+    for (size_t i = 0; i < n; ++i) {
+        serialLength[i] = static_cast<uint8_t>(std::min(frame.serial[i].size(), kMaxSerialLength));
+    }
+    append(serialLength, n);
+    for (size_t i = 0; i < n; ++i) {
+        append(frame.serial[i].data(), serialLength[i]);
+    }
+
+    return m_buffer;
+}
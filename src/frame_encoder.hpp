@@ -0,0 +1,82 @@
+#pragma once
+#include "tracker_frame.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Serializes a TrackerFrame into the byte layout sent over IPC.
+//
+// Wire format (native byte order):
+//   uint32 count
+//   uint8  encoding             (Encoding value)
+//   uint8  flags                (kFlagVelocity, kFlagSerials)
+//   uint8  deviceIndex[count]
+//   uint8  deviceClass[count]
+//   uint8  role[count]
+//   uint8  status[count]        (TrackerFrame::kStatus* bits)
+//   uint16 trackingResult[count]
+//   Float:     float x[], y[], z[], qw[], qx[], qy[], qz[]
+//   Quantized: int16 x[], y[], z[], uint32 rotation[] (smallest three)
+//   if kFlagVelocity:
+//     Float:     float vx[], vy[], vz[], avx[], avy[], avz[]
+//     Quantized: int16 vx[], vy[], vz[], avx[], avy[], avz[]
+//   if kFlagSerials:
+//     uint8  serialLength[count]
+//     char   serials[]          (concatenated, not null-terminated)
+//
+// Serial numbers only change with the device list, so they are sent with
+// the first frame and whenever they differ from the last frame sent.
+// Decoders keep the last received serials for frames without them.
+class FrameEncoder {
+public:
+    enum class Encoding : uint8_t {
+        Float = 0,      // 32-bit floats for all values
+        Quantized = 1   // 16-bit fixed point values, 32-bit packed rotations
+    };
+
+    static constexpr uint8_t kFlagVelocity = 1 << 0;
+    static constexpr uint8_t kFlagSerials = 1 << 1;
+
+    // Fixed point scales (units per meter, m/s and rad/s)
+    static constexpr float kPositionScale = 2048.0f;        // +-16 m, ~0.5 mm steps
+    static constexpr float kVelocityScale = 1024.0f;        // +-32 m/s
+    static constexpr float kAngularVelocityScale = 512.0f;  // +-64 rad/s
+
+    static constexpr size_t kMaxSerialLength = 255;
+
+    explicit FrameEncoder(Encoding encoding = Encoding::Float);
+
+    Encoding getEncoding() const { return m_encoding; }
+    void setEncoding(Encoding encoding) { m_encoding = encoding; }
+
+    // Encode a frame, including serial numbers only if they changed since
+    // the last frame; the returned buffer is reused by the next call
+    const std::vector<uint8_t>& encode(const TrackerFrame& frame);
+
+    // Encode a frame with or without serial numbers
+    const std::vector<uint8_t>& encode(const TrackerFrame& frame, bool includeSerials);
+
+    // Include serial numbers in the next frame, e.g. after a client connects
+    void resendSerials() { m_serialsSent = false; }
+
+    // Fixed point helpers, shared with decoders
+    static int16_t quantize(float value, float scale);
+    static float dequantize(int16_t value, float scale);
+
+    // Pack a unit quaternion as 2 bits for the largest component's index
+    // followed by the other three components in 10 bits each
+    static uint32_t packQuaternion(float qw, float qx, float qy, float qz);
+    static void unpackQuaternion(uint32_t packed, float& qw, float& qx, float& qy, float& qz);
+
+private:
+    template <typename T>
+    void append(const T* data, size_t count);
+
+    // Whether the frame's serial numbers differ from the last ones sent
+    bool serialsChanged(const TrackerFrame& frame) const;
+
+    Encoding m_encoding;
+    std::vector<uint8_t> m_buffer;
+    std::vector<std::string> m_sentSerials;
+    bool m_serialsSent;
+};
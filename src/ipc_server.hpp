@@ -1,7 +1,8 @@
 #pragma once
 #include <string>
 #include <vector>
-#include "tracker_manager.hpp"
+#include "tracker_frame.hpp"
+#include "frame_encoder.hpp"
 
 class IPCServer {
 public:
@@ -10,11 +11,15 @@ public:
     // Initialize the IPC server
     virtual bool initialize() = 0;
 
-    // Send tracker data through IPC
-    virtual bool sendTrackerData(const std::vector<TrackerManager::TrackerPose>& poses, 
-                               const std::vector<std::string>& serials) = 0;
+    // Send a frame of device data through IPC
+    virtual bool sendFrame(const TrackerFrame& frame) = 0;
+
+    // Select full float or quantized encoding for subsequent frames
+    void setEncoding(FrameEncoder::Encoding encoding) { m_encoder.setEncoding(encoding); }
 
 protected:
     // Helper to write data to IPC channel
     virtual bool writeData(const void* data, size_t size) = 0;
+
+    FrameEncoder m_encoder;
 };
\ No newline at end of file
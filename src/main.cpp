@@ -10,16 +10,47 @@
 #include <iomanip>
 #include <vector>
 #include <memory>
+#include <cstring>
+
+const char* deviceClassName(uint8_t deviceClass) {
+    switch (deviceClass) {
+        case vr::TrackedDeviceClass_HMD: return "HMD";
+        case vr::TrackedDeviceClass_Controller: return "Controller";
+        case vr::TrackedDeviceClass_GenericTracker: return "Tracker";
+        case vr::TrackedDeviceClass_TrackingReference: return "Base station";
+        case vr::TrackedDeviceClass_DisplayRedirect: return "Display redirect";
+        default: return "Unknown";
+    }
+}
 
-void printPose(const TrackerManager::TrackerPose& pose) {
+void printPose(const TrackerFrame& frame, size_t i) {
     std::cout << std::fixed << std::setprecision(3);
-    std::cout << "Position: (" << pose.x << ", " << pose.y << ", " << pose.z << ") m\n";
-    std::cout << "Rotation: [w:" << pose.qw << ", x:" << pose.qx
-              << ", y:" << pose.qy << ", z:" << pose.qz << "]\n";
+    std::cout << "Position: (" << frame.x[i] << ", " << frame.y[i] << ", " << frame.z[i] << ") m\n";
+    std::cout << "Rotation: [w:" << frame.qw[i] << ", x:" << frame.qx[i]
+              << ", y:" << frame.qy[i] << ", z:" << frame.qz[i] << "]\n";
+    if (frame.hasVelocity) {
+        std::cout << "Velocity: (" << frame.vx[i] << ", " << frame.vy[i] << ", " << frame.vz[i] << ") m/s\n";
+        std::cout << "Angular velocity: (" << frame.avx[i] << ", " << frame.avy[i] << ", "
+                  << frame.avz[i] << ") rad/s\n";
+    }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    bool quantized = false;
+    bool velocity = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--quantized") == 0) {
+            quantized = true;
+        } else if (strcmp(argv[i], "--velocity") == 0) {
+            velocity = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--quantized] [--velocity]\n";
+            return 1;
+        }
+    }
+
     TrackerManager manager;
+    manager.setVelocityEnabled(velocity);
 
     if (!manager.initialize()) {
         std::cerr << "Failed to initialize OpenVR\n";
@@ -47,8 +78,9 @@ int main() {
         return 1;
     }
 
-    std::vector<TrackerManager::TrackerPose> poses;
-    std::vector<std::string> serials;
+    ipcServer->setEncoding(quantized ? FrameEncoder::Encoding::Quantized : FrameEncoder::Encoding::Float);
+
+    TrackerFrame frame;
 
     // Main loop
     while (true) {
@@ -56,31 +88,23 @@ int main() {
         static auto lastUpdateTime = std::chrono::steady_clock::now();
         auto currentTime = std::chrono::steady_clock::now();
         if (std::chrono::duration_cast<std::chrono::seconds>(currentTime - lastUpdateTime).count() >= 1) {
-            manager.updateTrackerList();
+            manager.updateDeviceList();
             lastUpdateTime = currentTime;
         }
 
         manager.updatePoses();
-        size_t trackerCount = manager.getTrackerCount();
-
-        // Clear previous data
-        poses.clear();
-        serials.clear();
+        manager.fillFrame(frame);
+        size_t deviceCount = frame.count;
 
         std::cout << "\033[2J\033[H";  // Clear screen and move cursor to top
-        std::cout << "Found " << trackerCount << " trackers\n\n";
-
-        // Collect all tracker data
-        for (size_t i = 0; i < trackerCount; ++i) {
-            std::string serial = manager.getTrackerSerial(i);
-            auto pose = manager.getTrackerPose(i);
-
-            poses.push_back(pose);
-            serials.push_back(serial);
-
-            std::cout << "Tracker " << i + 1 << " (Serial: " << serial << ")\n";
-            if (pose.valid) {
-                printPose(pose);
+        std::cout << "Found " << deviceCount << " devices\n\n";
+
+        for (size_t i = 0; i < deviceCount; ++i) {
+            std::cout << deviceClassName(frame.deviceClass[i]) << " " << static_cast<int>(frame.deviceIndex[i])
+                      << " (Serial: " << frame.serial[i] << ", role: " << static_cast<int>(frame.role[i])
+                      << ", tracking result: " << frame.trackingResult[i] << ")\n";
+            if (frame.isValid(i)) {
+                printPose(frame, i);
             } else {
                 std::cout << "Invalid pose data\n";
             }
@@ -88,14 +112,14 @@ int main() {
         }
 
         // Send data through IPC with retry logic
-        if (trackerCount > 0) {
+        if (deviceCount > 0) {
             static int failureCount = 0;
             static bool wasConnected = true;
             const int maxRetries = 3;
             bool sendSuccess = false;
 
             for (int retry = 0; retry < maxRetries && !sendSuccess; retry++) {
-                if (ipcServer->sendTrackerData(poses, serials)) {
+                if (ipcServer->sendFrame(frame)) {
                     sendSuccess = true;
                     if (!wasConnected) {
                         std::cout << "IPC connection restored\n";
@@ -0,0 +1,37 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Snapshot of every active tracked device for a single update, stored as a
+// structure of arrays so each field can be written to the wire in one block.
+// Kept free of OpenVR types so the encoder can be used on its own.
+struct TrackerFrame {
+    static constexpr size_t kMaxDevices = 64;  // vr::k_unMaxTrackedDeviceCount
+
+    // Bits in the status array
+    static constexpr uint8_t kStatusPoseValid = 1 << 0;
+    static constexpr uint8_t kStatusConnected = 1 << 1;
+
+    uint32_t count = 0;         // Number of populated entries in each array
+    bool hasVelocity = false;   // Whether the velocity arrays are populated
+
+    std::array<uint8_t, kMaxDevices> deviceIndex{};     // OpenVR device index
+    std::array<uint8_t, kMaxDevices> deviceClass{};     // vr::ETrackedDeviceClass
+    std::array<uint8_t, kMaxDevices> role{};            // vr::ETrackedControllerRole
+    std::array<uint8_t, kMaxDevices> status{};          // kStatus* bits
+    std::array<uint16_t, kMaxDevices> trackingResult{}; // vr::ETrackingResult
+
+    // Position in meters
+    std::array<float, kMaxDevices> x{}, y{}, z{};
+    // Rotation quaternion
+    std::array<float, kMaxDevices> qw{}, qx{}, qy{}, qz{};
+    // Linear velocity in m/s and angular velocity in rad/s (only if hasVelocity)
+    std::array<float, kMaxDevices> vx{}, vy{}, vz{};
+    std::array<float, kMaxDevices> avx{}, avy{}, avz{};
+
+    std::array<std::string, kMaxDevices> serial;
+
+    bool isValid(size_t i) const { return (status[i] & kStatusPoseValid) != 0; }
+};
@@ -2,7 +2,10 @@
 #include <cstring>
 #include <cmath>
 
-TrackerManager::TrackerManager() : m_vrSystem(nullptr) {
+static_assert(TrackerFrame::kMaxDevices == vr::k_unMaxTrackedDeviceCount,
+              "TrackerFrame must hold every OpenVR device slot");
+
+TrackerManager::TrackerManager() : m_vrSystem(nullptr), m_velocityEnabled(false) {
     m_poses.resize(vr::k_unMaxTrackedDeviceCount);
 }
 
@@ -22,7 +25,7 @@ bool TrackerManager::initialize() {
         return false;
     }
 
-    updateTrackerList();
+    updateDeviceList();
     return true;
 }
 
@@ -37,30 +40,58 @@ void TrackerManager::updatePoses() {
     );
 }
 
-size_t TrackerManager::getTrackerCount() const {
-    return m_trackerIndices.size();
-}
+void TrackerManager::fillFrame(TrackerFrame& frame) const {
+    frame.count = static_cast<uint32_t>(m_devices.size());
+    frame.hasVelocity = m_velocityEnabled;
+
+    for (size_t i = 0; i < m_devices.size(); ++i) {
+        const auto& device = m_devices[i];
+        const auto& devicePose = m_poses[device.index];
+
+        frame.deviceIndex[i] = static_cast<uint8_t>(device.index);
+        frame.deviceClass[i] = static_cast<uint8_t>(device.deviceClass);
+        frame.role[i] = static_cast<uint8_t>(device.role);
+        frame.trackingResult[i] = static_cast<uint16_t>(devicePose.eTrackingResult);
+        frame.serial[i] = device.serial;
+
+        uint8_t status = 0;
+        if (devicePose.bPoseIsValid) status |= TrackerFrame::kStatusPoseValid;
+        if (devicePose.bDeviceIsConnected) status |= TrackerFrame::kStatusConnected;
+        frame.status[i] = status;
+
+        if (!devicePose.bPoseIsValid) {
+            frame.x[i] = frame.y[i] = frame.z[i] = 0.0f;
+            frame.qw[i] = 1.0f;
+            frame.qx[i] = frame.qy[i] = frame.qz[i] = 0.0f;
+            frame.vx[i] = frame.vy[i] = frame.vz[i] = 0.0f;
+            frame.avx[i] = frame.avy[i] = frame.avz[i] = 0.0f;
+            continue;
+        }
 
-TrackerManager::TrackerPose TrackerManager::getTrackerPose(size_t index) const {
-    TrackerPose pose = {0};
-    
-    if (index >= m_trackerIndices.size()) {
-        pose.valid = false;
-        return pose;
-    }
+        const auto& mat = devicePose.mDeviceToAbsoluteTracking.m;
+
+        // Position
+        frame.x[i] = mat[0][3];
+        frame.y[i] = mat[1][3];
+        frame.z[i] = mat[2][3];
 
-    const auto& devicePose = m_poses[m_trackerIndices[index]];
-    if (!devicePose.bPoseIsValid) {
-        pose.valid = false;
-        return pose;
+        matrixToQuaternion(devicePose.mDeviceToAbsoluteTracking,
+                           frame.qw[i], frame.qx[i], frame.qy[i], frame.qz[i]);
+
+        if (m_velocityEnabled) {
+            frame.vx[i] = devicePose.vVelocity.v[0];
+            frame.vy[i] = devicePose.vVelocity.v[1];
+            frame.vz[i] = devicePose.vVelocity.v[2];
+            frame.avx[i] = devicePose.vAngularVelocity.v[0];
+            frame.avy[i] = devicePose.vAngularVelocity.v[1];
+            frame.avz[i] = devicePose.vAngularVelocity.v[2];
+        }
     }
+}
 
-    const auto& mat = devicePose.mDeviceToAbsoluteTracking.m;
-    
-    // Position
-    pose.x = mat[0][3];
-    pose.y = mat[1][3];
-    pose.z = mat[2][3];
+void TrackerManager::matrixToQuaternion(const vr::HmdMatrix34_t& matrix,
+                                        float& qw, float& qx, float& qy, float& qz) {
+    const auto& mat = matrix.m;
 
     // Convert rotation matrix to quaternion using a numerically stable method
     float r11 = mat[0][0], r12 = mat[0][1], r13 = mat[0][2];
@@ -86,55 +117,52 @@ TrackerManager::TrackerPose TrackerManager::getTrackerPose(size_t index) const {
 
     switch (max_idx) {
         case 0: // qw is max
-            pose.qw = max_val;
-            pose.qx = (r32 - r23) * mult;
-            pose.qy = (r13 - r31) * mult;
-            pose.qz = (r21 - r12) * mult;
+            qw = max_val;
+            qx = (r32 - r23) * mult;
+            qy = (r13 - r31) * mult;
+            qz = (r21 - r12) * mult;
             break;
         case 1: // qx is max
-            pose.qx = max_val;
-            pose.qw = (r32 - r23) * mult;
-            pose.qy = (r12 + r21) * mult;
-            pose.qz = (r13 + r31) * mult;
+            qx = max_val;
+            qw = (r32 - r23) * mult;
+            qy = (r12 + r21) * mult;
+            qz = (r13 + r31) * mult;
             break;
         case 2: // qy is max
-            pose.qy = max_val;
-            pose.qw = (r13 - r31) * mult;
-            pose.qx = (r12 + r21) * mult;
-            pose.qz = (r23 + r32) * mult;
+            qy = max_val;
+            qw = (r13 - r31) * mult;
+            qx = (r12 + r21) * mult;
+            qz = (r23 + r32) * mult;
             break;
         case 3: // qz is max
-            pose.qz = max_val;
-            pose.qw = (r21 - r12) * mult;
-            pose.qx = (r13 + r31) * mult;
-            pose.qy = (r23 + r32) * mult;
+            qz = max_val;
+            qw = (r21 - r12) * mult;
+            qx = (r13 + r31) * mult;
+            qy = (r23 + r32) * mult;
             break;
     }
 
     // Normalize quaternion
-    float norm = sqrt(pose.qw * pose.qw + pose.qx * pose.qx + 
-                     pose.qy * pose.qy + pose.qz * pose.qz);
+    float norm = sqrt(qw * qw + qx * qx + 
+                     qy * qy + qz * qz);
     if (norm > 0.0001f) {
         float inv_norm = 1.0f / norm;
-        pose.qw *= inv_norm;
-        pose.qx *= inv_norm;
-        pose.qy *= inv_norm;
-        pose.qz *= inv_norm;
+        qw *= inv_norm;
+        qx *= inv_norm;
+        qy *= inv_norm;
+        qz *= inv_norm;
     }
-
-    pose.valid = true;
-    return pose;
 }
 
-std::string TrackerManager::getTrackerSerial(size_t index) const {
-    if (!m_vrSystem || index >= m_trackerIndices.size()) {
+std::string TrackerManager::readSerial(vr::TrackedDeviceIndex_t deviceIndex) const {
+    if (!m_vrSystem) {
         return "";
     }
 
     char buffer[vr::k_unMaxPropertyStringSize];
     vr::ETrackedPropertyError error;
     m_vrSystem->GetStringTrackedDeviceProperty(
-        m_trackerIndices[index],
+        deviceIndex,
         vr::Prop_SerialNumber_String,
         buffer,
         vr::k_unMaxPropertyStringSize,
@@ -148,20 +176,25 @@ std::string TrackerManager::getTrackerSerial(size_t index) const {
     return std::string(buffer);
 }
 
-bool TrackerManager::isTracker(vr::TrackedDeviceIndex_t deviceIndex) const {
+bool TrackerManager::isActiveDevice(vr::TrackedDeviceIndex_t deviceIndex) const {
     if (!m_vrSystem) return false;
 
-    return m_vrSystem->GetTrackedDeviceClass(deviceIndex) == vr::TrackedDeviceClass_GenericTracker;
+    return m_vrSystem->GetTrackedDeviceClass(deviceIndex) != vr::TrackedDeviceClass_Invalid;
 }
 
-void TrackerManager::updateTrackerList() {
-    m_trackerIndices.clear();
+void TrackerManager::updateDeviceList() {
+    m_devices.clear();
     
     if (!m_vrSystem) return;
 
     for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i) {
-        if (isTracker(i)) {
-            m_trackerIndices.push_back(i);
+        if (isActiveDevice(i)) {
+            Device device;
+            device.index = i;
+            device.deviceClass = m_vrSystem->GetTrackedDeviceClass(i);
+            device.role = m_vrSystem->GetControllerRoleForTrackedDeviceIndex(i);
+            device.serial = readSerial(i);
+            m_devices.push_back(device);
         }
     }
 }
\ No newline at end of file
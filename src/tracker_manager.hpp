@@ -3,15 +3,10 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include "tracker_frame.hpp"
 
 class TrackerManager {
 public:
-    struct TrackerPose {
-        float x, y, z;           // Position in meters
-        float qw, qx, qy, qz;    // Rotation quaternion
-        bool valid;              // Whether the pose is valid
-    };
-
     TrackerManager();
     ~TrackerManager();
 
@@ -21,23 +16,36 @@ public:
     // Update poses for all tracked devices
     void updatePoses();
 
-    // Get number of active trackers (excluding HMD and controllers)
-    size_t getTrackerCount() const;
+    // Fill a frame with the latest pose data for all active devices
+    // (HMD, controllers, trackers and base stations)
+    void fillFrame(TrackerFrame& frame) const;
 
-    // Get pose data for a specific tracker
-    TrackerPose getTrackerPose(size_t index) const;
+    // Include linear and angular velocities in filled frames
+    void setVelocityEnabled(bool enabled) { m_velocityEnabled = enabled; }
 
-    // Get serial number for a specific tracker
-    std::string getTrackerSerial(size_t index) const;
-
-    // Update list of connected trackers
-    void updateTrackerList();
+    // Update list of connected devices, their roles and serial numbers
+    void updateDeviceList();
 
 private:
+    struct Device {
+        vr::TrackedDeviceIndex_t index;
+        vr::ETrackedDeviceClass deviceClass;
+        vr::ETrackedControllerRole role;
+        std::string serial;
+    };
+
     vr::IVRSystem* m_vrSystem;
-    std::vector<vr::TrackedDeviceIndex_t> m_trackerIndices;
+    std::vector<Device> m_devices;
     std::vector<vr::TrackedDevicePose_t> m_poses;
-    
-    // Helper to check if device is a tracker
-    bool isTracker(vr::TrackedDeviceIndex_t deviceIndex) const;
-};
\ No newline at end of file
+    bool m_velocityEnabled;
+
+    // Helper to check if a device slot is in use
+    bool isActiveDevice(vr::TrackedDeviceIndex_t deviceIndex) const;
+
+    // Helper to read a device's serial number
+    std::string readSerial(vr::TrackedDeviceIndex_t deviceIndex) const;
+
+    // Convert the rotation part of a pose matrix to a normalized quaternion
+    static void matrixToQuaternion(const vr::HmdMatrix34_t& matrix,
+                                   float& qw, float& qx, float& qy, float& qz);
+};
@@ -63,6 +63,7 @@ bool UnixSocketServer::initialize() {
     }
 
     m_isConnected = true;
+    m_encoder.resendSerials();  // A new client has not seen any serial numbers yet
     std::cout << "Client connected successfully!" << std::endl;
     return true;
 }
@@ -88,49 +89,12 @@ bool UnixSocketServer::writeData(const void* data, size_t size) {
     return true;
 }
 
-bool UnixSocketServer::sendTrackerData(const std::vector<TrackerManager::TrackerPose>& poses,
-                                     const std::vector<std::string>& serials) {
-    if (poses.size() != serials.size()) {
+bool UnixSocketServer::sendFrame(const TrackerFrame& frame) {
+    // Write the whole frame in one call
+    const auto& buffer = m_encoder.encode(frame);
+    if (!writeData(buffer.data(), buffer.size())) {
+        m_encoder.resendSerials();  // The client may have missed them
         return false;
     }
-
-    // Write number of trackers
-    uint32_t numTrackers = static_cast<uint32_t>(poses.size());
-    if (!writeData(&numTrackers, sizeof(numTrackers))) {
-        return false;
-    }
-
-    // Write data for each tracker
-    for (size_t i = 0; i < poses.size(); ++i) {
-        const auto& pose = poses[i];
-        const auto& serial = serials[i];
-
-        // Write position
-        if (!writeData(&pose.x, sizeof(float) * 3)) {
-            return false;
-        }
-
-        // Write rotation
-        float rotation[4] = {pose.qw, pose.qx, pose.qy, pose.qz};
-        if (!writeData(rotation, sizeof(float) * 4)) {
-            return false;
-        }
-
-        // Write validity
-        uint8_t valid = pose.valid ? 1 : 0;
-        if (!writeData(&valid, sizeof(uint8_t))) {
-            return false;
-        }
-
-        // Write serial number
-        uint32_t serialLength = static_cast<uint32_t>(serial.length());
-        if (!writeData(&serialLength, sizeof(uint32_t))) {
-            return false;
-        }
-        if (!writeData(serial.c_str(), serialLength)) {
-            return false;
-        }
-    }
-
     return true;
 }
\ No newline at end of file
@@ -8,8 +8,7 @@ public:
     ~WinPipeServer();
 
     bool initialize() override;
-    bool sendTrackerData(const std::vector<TrackerManager::TrackerPose>& poses,
-                        const std::vector<std::string>& serials) override;
+    bool sendFrame(const TrackerFrame& frame) override;
 
 private:
     bool writeData(const void* data, size_t size) override;
@@ -0,0 +1,60 @@
+#include "frame_encoder.hpp"
+#include "frame_decoder.hpp"
+#include "test_frames.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+// Measures decode throughput for full 64 device frames in every encoding.
+// Serial numbers are only sent when they change, so the frame decoded in the
+// loop is the steady state frame without them.
+// Usage: decoder_benchmark [frames]
+int main(int argc, char* argv[]) {
+    long frames = argc > 1 ? strtol(argv[1], nullptr, 10) : 1000000;
+    if (frames <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [frames]\n";
+        return 1;
+    }
+
+    std::mt19937 rng(0x62656e63);
+    TrackerFrame input;
+    TrackerFrame output;
+
+    for (FrameEncoder::Encoding encoding : {FrameEncoder::Encoding::Float, FrameEncoder::Encoding::Quantized}) {
+        for (bool hasVelocity : {false, true}) {
+            FrameEncoder encoder(encoding);
+            randomFrame(rng, input, TrackerFrame::kMaxDevices, hasVelocity, false);
+            for (uint32_t i = 0; i < input.count; ++i) {
+                input.serial[i] = "LHR-" + std::to_string(10000000 + i);
+            }
+            const size_t firstSize = encoder.encode(input).size();
+            const auto bytes = encoder.encode(input);
+
+            FrameDecoder::Info info;
+            size_t checksum = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (long i = 0; i < frames; ++i) {
+                if (FrameDecoder::decode(bytes.data(), bytes.size(), output, info) != FrameDecoder::Result::Ok) {
+                    std::cerr << "Decode failed\n";
+                    return 1;
+                }
+                checksum += info.size + output.deviceIndex[i % output.count];
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            double seconds = std::chrono::duration<double>(end - start).count();
+            double framesPerSecond = frames / seconds;
+            std::cout << std::left << std::setw(10)
+                      << (encoding == FrameEncoder::Encoding::Float ? "float" : "quantized")
+                      << std::setw(15) << (hasVelocity ? "+velocity" : "")
+                      << std::right << std::setw(6) << bytes.size() << " bytes/frame ("
+                      << std::setw(4) << firstSize << " with serials)  "
+                      << std::fixed << std::setprecision(0) << std::setw(12) << framesPerSecond << " frames/s"
+                      << "  (checksum " << checksum << ")\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include "frame_encoder.hpp"
+#include "frame_decoder.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// libFuzzer entry point: the decoder must never read out of bounds, and any
+// frame it accepts must encode back to the same size (and, for the float
+// encoding, the same bytes).
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static TrackerFrame frame;
+    static FrameEncoder encoder;
+
+    FrameDecoder::Info info;
+    if (FrameDecoder::decode(data, size, frame, info) != FrameDecoder::Result::Ok) {
+        return 0;
+    }
+    if (info.size > size) {
+        abort();
+    }
+
+    encoder.setEncoding(info.encoding);
+    const auto& bytes = encoder.encode(frame, info.hasSerials);
+    if (bytes.size() != info.size) {
+        abort();
+    }
+    if (info.encoding == FrameEncoder::Encoding::Float && memcmp(bytes.data(), data, info.size) != 0) {
+        abort();
+    }
+
+    return 0;
+}
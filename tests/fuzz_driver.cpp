@@ -0,0 +1,53 @@
+#include "frame_encoder.hpp"
+#include "test_frames.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// Stand-in for libFuzzer when building without Clang: feeds encoded frames
+// with random mutations, truncations and plain random bytes to the harness.
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? strtol(argv[1], nullptr, 10) : 100000;
+    std::mt19937 rng(0x66757a7a);
+    std::uniform_int_distribution<uint32_t> count(0, TrackerFrame::kMaxDevices);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    TrackerFrame frame;
+    FrameEncoder encoder;
+    std::vector<uint8_t> input;
+
+    for (long i = 0; i < iterations; ++i) {
+        switch (i % 4) {
+            case 0: {
+                // Plain random bytes
+                input.resize(rng() % 512);
+                for (auto& b : input) b = static_cast<uint8_t>(byte(rng));
+                break;
+            }
+            default: {
+                // Valid frame with a few mutations
+                encoder.setEncoding(rng() % 2 ? FrameEncoder::Encoding::Quantized : FrameEncoder::Encoding::Float);
+                randomFrame(rng, frame, count(rng), rng() % 2 == 0, true);
+                const auto& bytes = encoder.encode(frame);
+                input.assign(bytes.begin(), bytes.end());
+
+                int mutations = i % 4 == 1 ? 0 : static_cast<int>(rng() % 4);
+                for (int m = 0; m < mutations && !input.empty(); ++m) {
+                    input[rng() % input.size()] ^= static_cast<uint8_t>(1u << (rng() % 8));
+                }
+                if (i % 4 == 3 && !input.empty()) {
+                    input.resize(rng() % input.size());
+                }
+                break;
+            }
+        }
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    std::cout << "Ran " << iterations << " fuzz inputs\n";
+    return 0;
+}
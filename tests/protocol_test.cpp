@@ -0,0 +1,420 @@
+#include "frame_encoder.hpp"
+#include "frame_decoder.hpp"
+#include "test_frames.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << message << "\n"; \
+            ++failures; \
+        } \
+    } while (0)
+
+using Encoding = FrameEncoder::Encoding;
+using FloatArray = std::array<float, TrackerFrame::kMaxDevices>;
+
+static bool sameBits(float a, float b) {
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static void checkFixed(const FloatArray& expected, const FloatArray& actual, uint32_t count, float scale,
+                       const char* name) {
+    for (uint32_t i = 0; i < count; ++i) {
+        float quantized = FrameEncoder::dequantize(FrameEncoder::quantize(expected[i], scale), scale);
+        CHECK(sameBits(quantized, actual[i]), name << "[" << i << "] decoded as " << actual[i]);
+        if (std::isfinite(expected[i]) && std::fabs(expected[i] * scale) < 32767.0f) {
+            CHECK(std::fabs(expected[i] - actual[i]) <= 0.5f / scale + 1e-6f,
+                  name << "[" << i << "] error too large: " << expected[i] << " vs " << actual[i]);
+        }
+    }
+}
+
+static void checkFrame(const TrackerFrame& expected, const TrackerFrame& actual, Encoding encoding) {
+    const uint32_t n = expected.count;
+    CHECK(actual.count == n, "count " << actual.count << " != " << n);
+    CHECK(actual.hasVelocity == expected.hasVelocity, "velocity flag mismatch");
+    if (actual.count != n) return;
+
+    for (uint32_t i = 0; i < n; ++i) {
+        CHECK(actual.deviceIndex[i] == expected.deviceIndex[i], "deviceIndex[" << i << "] mismatch");
+        CHECK(actual.deviceClass[i] == expected.deviceClass[i], "deviceClass[" << i << "] mismatch");
+        CHECK(actual.role[i] == expected.role[i], "role[" << i << "] mismatch");
+        CHECK(actual.status[i] == expected.status[i], "status[" << i << "] mismatch");
+        CHECK(actual.trackingResult[i] == expected.trackingResult[i], "trackingResult[" << i << "] mismatch");
+        CHECK(actual.serial[i] == expected.serial[i].substr(0, FrameEncoder::kMaxSerialLength),
+              "serial[" << i << "] mismatch (length " << expected.serial[i].size() << ")");
+    }
+
+    if (encoding == Encoding::Float) {
+        const FloatArray TrackerFrame::* fields[] = {
+            &TrackerFrame::x, &TrackerFrame::y, &TrackerFrame::z,
+            &TrackerFrame::qw, &TrackerFrame::qx, &TrackerFrame::qy, &TrackerFrame::qz,
+            &TrackerFrame::vx, &TrackerFrame::vy, &TrackerFrame::vz,
+            &TrackerFrame::avx, &TrackerFrame::avy, &TrackerFrame::avz
+        };
+        size_t fieldCount = expected.hasVelocity ? 13 : 7;
+        for (size_t f = 0; f < fieldCount; ++f) {
+            for (uint32_t i = 0; i < n; ++i) {
+                CHECK(sameBits((expected.*fields[f])[i], (actual.*fields[f])[i]),
+                      "float field " << f << "[" << i << "] not bit exact");
+            }
+        }
+        return;
+    }
+
+    checkFixed(expected.x, actual.x, n, FrameEncoder::kPositionScale, "x");
+    checkFixed(expected.y, actual.y, n, FrameEncoder::kPositionScale, "y");
+    checkFixed(expected.z, actual.z, n, FrameEncoder::kPositionScale, "z");
+    if (expected.hasVelocity) {
+        checkFixed(expected.vx, actual.vx, n, FrameEncoder::kVelocityScale, "vx");
+        checkFixed(expected.vy, actual.vy, n, FrameEncoder::kVelocityScale, "vy");
+        checkFixed(expected.vz, actual.vz, n, FrameEncoder::kVelocityScale, "vz");
+        checkFixed(expected.avx, actual.avx, n, FrameEncoder::kAngularVelocityScale, "avx");
+        checkFixed(expected.avy, actual.avy, n, FrameEncoder::kAngularVelocityScale, "avy");
+        checkFixed(expected.avz, actual.avz, n, FrameEncoder::kAngularVelocityScale, "avz");
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        // Any input must decode to a finite unit quaternion
+        float norm = std::sqrt(actual.qw[i] * actual.qw[i] + actual.qx[i] * actual.qx[i] +
+                               actual.qy[i] * actual.qy[i] + actual.qz[i] * actual.qz[i]);
+        CHECK(std::isfinite(norm) && std::fabs(norm - 1.0f) < 1e-3f, "rotation[" << i << "] not unit: " << norm);
+
+        // Unit input must come back as the same rotation (q and -q are equal)
+        float inputNorm = std::sqrt(expected.qw[i] * expected.qw[i] + expected.qx[i] * expected.qx[i] +
+                                    expected.qy[i] * expected.qy[i] + expected.qz[i] * expected.qz[i]);
+        if (std::fabs(inputNorm - 1.0f) < 1e-4f) {
+            float dot = expected.qw[i] * actual.qw[i] + expected.qx[i] * actual.qx[i] +
+                        expected.qy[i] * actual.qy[i] + expected.qz[i] * actual.qz[i];
+            CHECK(std::fabs(dot) > 0.9999f, "rotation[" << i << "] differs, |dot| = " << std::fabs(dot));
+        }
+    }
+}
+
+static void testRoundTrip(std::mt19937& rng) {
+    TrackerFrame input;
+    TrackerFrame output;
+
+    for (Encoding encoding : {Encoding::Float, Encoding::Quantized}) {
+        FrameEncoder encoder(encoding);
+        for (uint32_t count = 0; count <= TrackerFrame::kMaxDevices; ++count) {
+            for (int variant = 0; variant < 4; ++variant) {
+                bool hasVelocity = (variant & 1) != 0;
+                bool allowInvalid = (variant & 2) != 0;
+                randomFrame(rng, input, count, hasVelocity, allowInvalid);
+
+                const auto& bytes = encoder.encode(input, true);
+                FrameDecoder::Info info;
+                auto result = FrameDecoder::decode(bytes.data(), bytes.size(), output, info);
+
+                CHECK(result == FrameDecoder::Result::Ok, "round trip of " << count << " devices failed");
+                if (result != FrameDecoder::Result::Ok) continue;
+                CHECK(info.size == bytes.size(), "decoded " << info.size << " of " << bytes.size() << " bytes");
+                CHECK(info.encoding == encoding, "encoding mismatch");
+                CHECK(info.hasSerials, "serials missing");
+                checkFrame(input, output, encoding);
+            }
+        }
+    }
+}
+
+static void testTruncation(std::mt19937& rng) {
+    TrackerFrame input;
+    TrackerFrame output;
+
+    // The last good frame, which incomplete decodes must leave untouched
+    TrackerFrame previous;
+    randomFrame(rng, previous, 5, false, false);
+    FrameEncoder snapshotEncoder;
+    const auto expected = snapshotEncoder.encode(previous, true);
+
+    for (Encoding encoding : {Encoding::Float, Encoding::Quantized}) {
+        FrameEncoder encoder(encoding);
+        randomFrame(rng, input, 9, true, true);
+        const auto& bytes = encoder.encode(input, true);
+
+        // Every strict prefix must ask for more data rather than decode garbage
+        for (size_t size = 0; size < bytes.size(); ++size) {
+            output = previous;
+            FrameDecoder::Info info;
+            auto result = FrameDecoder::decode(bytes.data(), size, output, info);
+            CHECK(result == FrameDecoder::Result::Incomplete, "prefix of " << size << " bytes was not incomplete");
+            CHECK(snapshotEncoder.encode(output, true) == expected,
+                  "prefix of " << size << " bytes modified the frame");
+        }
+    }
+}
+
+static void testStream(std::mt19937& rng) {
+    // A stream of frames with varying encodings, some repeating the previous
+    // device list and so sent without serials, must stay in sync
+    std::vector<uint8_t> stream;
+    std::vector<TrackerFrame> frames(50);
+    std::vector<Encoding> encodings;
+    std::uniform_int_distribution<uint32_t> count(0, TrackerFrame::kMaxDevices);
+    FrameEncoder encoder;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        auto& frame = frames[i];
+        Encoding encoding = rng() % 2 ? Encoding::Quantized : Encoding::Float;
+        encoder.setEncoding(encoding);
+        if (i > 0 && rng() % 2 == 0) {
+            uint32_t previousCount = frames[i - 1].count;
+            randomFrame(rng, frame, previousCount, rng() % 2 == 0, true);
+            frame.serial = frames[i - 1].serial;
+        } else {
+            randomFrame(rng, frame, count(rng), rng() % 2 == 0, true);
+        }
+        const auto& bytes = encoder.encode(frame);
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+        encodings.push_back(encoding);
+    }
+
+    size_t offset = 0;
+    TrackerFrame output;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        FrameDecoder::Info info;
+        auto result = FrameDecoder::decode(stream.data() + offset, stream.size() - offset, output, info);
+        CHECK(result == FrameDecoder::Result::Ok, "stream frame " << i << " failed to decode");
+        if (result != FrameDecoder::Result::Ok) return;
+        CHECK(info.encoding == encodings[i], "stream frame " << i << " encoding mismatch");
+        checkFrame(frames[i], output, encodings[i]);
+        offset += info.size;
+    }
+    CHECK(offset == stream.size(), "stream has " << stream.size() - offset << " trailing bytes");
+}
+
+static void testSerialsOnChange(std::mt19937& rng) {
+    TrackerFrame input;
+    TrackerFrame output;
+    FrameDecoder::Info info;
+    FrameEncoder encoder(Encoding::Quantized);
+    randomFrame(rng, input, 12, false, false);
+
+    auto roundTrip = [&]() {
+        const auto& bytes = encoder.encode(input);
+        bool ok = FrameDecoder::decode(bytes.data(), bytes.size(), output, info) == FrameDecoder::Result::Ok;
+        CHECK(ok, "frame failed to decode");
+        return ok ? info.hasSerials : false;
+    };
+
+    CHECK(roundTrip(), "first frame must carry serials");
+    CHECK(!roundTrip(), "unchanged serials were sent again");
+    checkFrame(input, output, Encoding::Quantized);
+
+    input.serial[3] = "LHR-CHANGED";
+    CHECK(roundTrip(), "changed serial was not sent");
+    CHECK(!roundTrip(), "serials sent twice after a change");
+    checkFrame(input, output, Encoding::Quantized);
+
+    encoder.resendSerials();
+    CHECK(roundTrip(), "serials not sent after resendSerials");
+
+    input.count = 11;
+    CHECK(roundTrip(), "serials not sent after the device count changed");
+    checkFrame(input, output, Encoding::Quantized);
+}
+
+// Read the [name] sections of hex bytes from the shared fixture file
+static std::map<std::string, std::vector<uint8_t>> loadFixtures(const char* path) {
+    std::map<std::string, std::vector<uint8_t>> fixtures;
+    std::ifstream file(path);
+    CHECK(file.good(), "cannot open fixture file " << path);
+
+    std::string line;
+    std::vector<uint8_t>* current = nullptr;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        if (line.find('[') != std::string::npos) {
+            size_t start = line.find('[') + 1;
+            current = &fixtures[line.substr(start, line.find(']') - start)];
+            continue;
+        }
+        std::istringstream tokens(line);
+        std::string token;
+        while (tokens >> token) {
+            CHECK(current != nullptr, "fixture bytes outside a section");
+            if (current) current->push_back(static_cast<uint8_t>(std::stoul(token, nullptr, 16)));
+        }
+    }
+    return fixtures;
+}
+
+// The two devices described at the top of the fixture file
+static TrackerFrame fixtureFrame(bool hasVelocity) {
+    TrackerFrame frame;
+    frame.count = 2;
+    frame.hasVelocity = hasVelocity;
+
+    frame.deviceIndex[0] = 0;  frame.deviceIndex[1] = 3;
+    frame.deviceClass[0] = 1;  frame.deviceClass[1] = 2;
+    frame.role[0] = 0;         frame.role[1] = 2;
+    frame.status[0] = TrackerFrame::kStatusPoseValid | TrackerFrame::kStatusConnected;
+    frame.status[1] = TrackerFrame::kStatusPoseValid;
+    frame.trackingResult[0] = 200;
+    frame.trackingResult[1] = 201;
+
+    frame.x[0] = 1.0f;    frame.x[1] = -2.0f;
+    frame.y[0] = 1.5f;    frame.y[1] = 0.75f;
+    frame.z[0] = -0.25f;  frame.z[1] = 0.5f;
+    frame.qw[0] = 1.0f;   frame.qw[1] = 0.0f;
+    frame.qx[0] = 0.0f;   frame.qx[1] = 0.0f;
+    frame.qy[0] = 0.0f;   frame.qy[1] = 1.0f;
+    frame.qz[0] = 0.0f;   frame.qz[1] = 0.0f;
+
+    frame.vx[0] = 0.5f;   frame.vx[1] = 0.0f;
+    frame.vy[0] = 0.0f;   frame.vy[1] = 0.0f;
+    frame.vz[0] = -1.0f;  frame.vz[1] = 0.0f;
+    frame.avx[0] = 0.0f;  frame.avx[1] = -1.0f;
+    frame.avy[0] = 2.0f;  frame.avy[1] = 0.0f;
+    frame.avz[0] = 0.0f;  frame.avz[1] = 0.5f;
+
+    frame.serial[0] = "HMD1";
+    frame.serial[1] = "LHR-1";
+    return frame;
+}
+
+static void testWireFixtures(const char* path) {
+    struct Case {
+        const char* name;
+        Encoding encoding;
+        bool hasVelocity;
+        bool hasSerials;
+    };
+    const Case cases[] = {
+        {"float", Encoding::Float, false, true},
+        {"float_velocity", Encoding::Float, true, true},
+        {"quantized", Encoding::Quantized, false, true},
+        {"quantized_velocity", Encoding::Quantized, true, true},
+        {"quantized_no_serials", Encoding::Quantized, false, false},
+    };
+
+    auto fixtures = loadFixtures(path);
+    TrackerFrame output;
+    for (const auto& c : cases) {
+        auto it = fixtures.find(c.name);
+        CHECK(it != fixtures.end(), "fixture " << c.name << " missing");
+        if (it == fixtures.end()) continue;
+        const auto& expected = it->second;
+        const TrackerFrame frame = fixtureFrame(c.hasVelocity);
+
+        // The encoder must produce exactly the hand-written bytes
+        FrameEncoder encoder(c.encoding);
+        const auto& bytes = encoder.encode(frame, c.hasSerials);
+        CHECK(bytes.size() == expected.size(),
+              c.name << ": encoded " << bytes.size() << " bytes, fixture has " << expected.size());
+        for (size_t i = 0; i < std::min(bytes.size(), expected.size()); ++i) {
+            if (bytes[i] != expected[i]) {
+                CHECK(false, c.name << ": first difference at byte " << i);
+                break;
+            }
+        }
+
+        // The decoder must recover the described values from the fixture;
+        // frames without serials keep the ones from the previous fixture
+        FrameDecoder::Info info;
+        auto result = FrameDecoder::decode(expected.data(), expected.size(), output, info);
+        CHECK(result == FrameDecoder::Result::Ok, c.name << ": fixture failed to decode");
+        if (result != FrameDecoder::Result::Ok) continue;
+        CHECK(info.size == expected.size(), c.name << ": decoded " << info.size << " bytes");
+        CHECK(info.encoding == c.encoding, c.name << ": encoding mismatch");
+        CHECK(info.hasSerials == c.hasSerials, c.name << ": serial flag mismatch");
+        CHECK(output.count == 2 && output.hasVelocity == c.hasVelocity, c.name << ": header mismatch");
+
+        const float tolerance = c.encoding == Encoding::Float ? 0.0f : 2e-3f;
+        auto near = [&](float a, float b) { return std::fabs(a - b) <= tolerance; };
+        for (size_t i = 0; i < 2; ++i) {
+            CHECK(output.deviceIndex[i] == frame.deviceIndex[i] && output.deviceClass[i] == frame.deviceClass[i] &&
+                  output.role[i] == frame.role[i] && output.status[i] == frame.status[i] &&
+                  output.trackingResult[i] == frame.trackingResult[i], c.name << ": metadata " << i << " mismatch");
+            CHECK(output.x[i] == frame.x[i] && output.y[i] == frame.y[i] && output.z[i] == frame.z[i],
+                  c.name << ": position " << i << " mismatch");
+            CHECK(near(output.qw[i], frame.qw[i]) && near(output.qx[i], frame.qx[i]) &&
+                  near(output.qy[i], frame.qy[i]) && near(output.qz[i], frame.qz[i]),
+                  c.name << ": rotation " << i << " mismatch");
+            if (c.hasVelocity) {
+                CHECK(output.vx[i] == frame.vx[i] && output.vy[i] == frame.vy[i] && output.vz[i] == frame.vz[i] &&
+                      output.avx[i] == frame.avx[i] && output.avy[i] == frame.avy[i] &&
+                      output.avz[i] == frame.avz[i], c.name << ": velocity " << i << " mismatch");
+            }
+            CHECK(output.serial[i] == frame.serial[i], c.name << ": serial " << i << " mismatch");
+        }
+    }
+}
+
+static void testInvalidHeaders() {
+    TrackerFrame output;
+    FrameDecoder::Info info;
+
+    auto header = [](uint32_t count, uint8_t encoding, uint8_t flags) {
+        std::vector<uint8_t> bytes(FrameDecoder::kHeaderSize + 4096, 0);
+        memcpy(bytes.data(), &count, sizeof(count));
+        bytes[4] = encoding;
+        bytes[5] = flags;
+        return bytes;
+    };
+
+    auto tooMany = header(TrackerFrame::kMaxDevices + 1, 0, 0);
+    CHECK(FrameDecoder::decode(tooMany.data(), tooMany.size(), output, info) ==
+          FrameDecoder::Result::Invalid, "device count above maximum accepted");
+
+    auto huge = header(0xFFFFFFFFu, 0, 0);
+    CHECK(FrameDecoder::decode(huge.data(), huge.size(), output, info) ==
+          FrameDecoder::Result::Invalid, "huge device count accepted");
+
+    auto badEncoding = header(1, 2, 0);
+    CHECK(FrameDecoder::decode(badEncoding.data(), badEncoding.size(), output, info) ==
+          FrameDecoder::Result::Invalid, "unknown encoding accepted");
+
+    auto badFlags = header(1, 0, 0x84);
+    CHECK(FrameDecoder::decode(badFlags.data(), badFlags.size(), output, info) ==
+          FrameDecoder::Result::Invalid, "unknown flags accepted");
+}
+
+static void testQuantizedSize() {
+    // Per device bytes in frames without serials, which are only sent when the
+    // device list changes, must be less than half of the float encoding
+    TrackerFrame frame;
+    FrameEncoder floatEncoder(Encoding::Float);
+    FrameEncoder quantizedEncoder(Encoding::Quantized);
+    for (bool hasVelocity : {false, true}) {
+        frame.hasVelocity = hasVelocity;
+        frame.count = 0;
+        size_t floatBase = floatEncoder.encode(frame, false).size();
+        size_t quantizedBase = quantizedEncoder.encode(frame, false).size();
+        frame.count = 1;
+        size_t floatPerDevice = floatEncoder.encode(frame, false).size() - floatBase;
+        size_t quantizedPerDevice = quantizedEncoder.encode(frame, false).size() - quantizedBase;
+        CHECK(quantizedPerDevice * 2 < floatPerDevice,
+              "quantized device uses " << quantizedPerDevice << " bytes vs " << floatPerDevice << " for float");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::mt19937 rng(0x7261636b);
+
+    testWireFixtures(argc > 1 ? argv[1] : WIRE_FIXTURES);
+    testRoundTrip(rng);
+    testTruncation(rng);
+    testStream(rng);
+    testSerialsOnChange(rng);
+    testInvalidHeaders();
+    testQuantizedSize();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All protocol tests passed\n";
+    return 0;
+}
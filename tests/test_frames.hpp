@@ -0,0 +1,90 @@
+#pragma once
+#include "tracker_frame.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+// Random frame generation shared by the protocol tests, fuzz driver and benchmark
+inline std::string randomSerial(std::mt19937& rng) {
+    static const size_t lengths[] = {0, 1, 12, 254, 255, 256, 1000};
+    std::uniform_int_distribution<int> pick(0, 9);
+    int choice = pick(rng);
+
+    // Mostly realistic serials, sometimes edge-case lengths and arbitrary bytes
+    size_t length = choice < 7 ? lengths[choice] : 8 + choice;
+    bool binary = choice == 0 || choice >= 3;
+    std::string serial(length, '\0');
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> printable('0', 'Z');
+    for (auto& c : serial) {
+        c = static_cast<char>(binary ? byte(rng) : printable(rng));
+    }
+    return serial;
+}
+
+inline float randomValue(std::mt19937& rng, float range, bool allowInvalid) {
+    std::uniform_int_distribution<int> pick(0, 19);
+    if (allowInvalid) {
+        switch (pick(rng)) {
+            case 0: return std::numeric_limits<float>::quiet_NaN();
+            case 1: return std::numeric_limits<float>::infinity();
+            case 2: return -std::numeric_limits<float>::infinity();
+            case 3: return range * 4.0f;  // Outside the quantized range
+            default: break;
+        }
+    }
+    std::uniform_real_distribution<float> value(-range, range);
+    return value(rng);
+}
+
+// Fill a frame with count devices. With allowInvalid, poses may contain NaN,
+// infinities, out of range values and non-normalized quaternions.
+inline void randomFrame(std::mt19937& rng, TrackerFrame& frame, uint32_t count, bool hasVelocity, bool allowInvalid) {
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> trackingResult(0, 65535);
+    std::uniform_int_distribution<int> pick(0, 9);
+
+    frame.count = count;
+    frame.hasVelocity = hasVelocity;
+    for (uint32_t i = 0; i < count; ++i) {
+        frame.deviceIndex[i] = static_cast<uint8_t>(byte(rng));
+        frame.deviceClass[i] = static_cast<uint8_t>(byte(rng));
+        frame.role[i] = static_cast<uint8_t>(byte(rng));
+        frame.status[i] = static_cast<uint8_t>(byte(rng));
+        frame.trackingResult[i] = static_cast<uint16_t>(trackingResult(rng));
+
+        frame.x[i] = randomValue(rng, 15.0f, allowInvalid);
+        frame.y[i] = randomValue(rng, 15.0f, allowInvalid);
+        frame.z[i] = randomValue(rng, 15.0f, allowInvalid);
+
+        float q[4];
+        float norm = 0.0f;
+        for (float& c : q) {
+            c = randomValue(rng, 1.0f, false);
+            norm += c * c;
+        }
+        norm = std::sqrt(norm);
+        bool invalidRotation = allowInvalid && pick(rng) == 0;
+        for (float& c : q) {
+            c = invalidRotation ? c * 3.0f : c / norm;
+        }
+        if (allowInvalid && pick(rng) == 0) {
+            q[0] = q[1] = q[2] = q[3] = 0.0f;
+        }
+        frame.qw[i] = q[0];
+        frame.qx[i] = q[1];
+        frame.qy[i] = q[2];
+        frame.qz[i] = q[3];
+
+        frame.vx[i] = randomValue(rng, 30.0f, allowInvalid);
+        frame.vy[i] = randomValue(rng, 30.0f, allowInvalid);
+        frame.vz[i] = randomValue(rng, 30.0f, allowInvalid);
+        frame.avx[i] = randomValue(rng, 60.0f, allowInvalid);
+        frame.avy[i] = randomValue(rng, 60.0f, allowInvalid);
+        frame.avz[i] = randomValue(rng, 60.0f, allowInvalid);
+
+        frame.serial[i] = randomSerial(rng);
+    }
+}